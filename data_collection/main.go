@@ -3,10 +3,12 @@ package main
 import (
 	"context"
 	"encoding/binary"
+	"flag"
 	"fmt"
 	"log"
 	"net/http"
 	"os"
+	"sort"
 	"sync"
 	"unicode/utf8"
 
@@ -145,15 +147,12 @@ func (output *BinaryOutput) AddString(value string) {
 	output.data = append(output.data, WriteString(value)...)
 }
 
-func main() {
+// Write the pages with links to a binary file
+func write_data(path string, pages_reverse map[uint32]string, links map[uint32][]uint32) {
 	// Create a file for output
-	file, _ := os.Create("data.bin")
+	file, _ := os.Create(path)
 	defer file.Close()
 
-	// get the pages and their links
-	pages, pages_reverse := load_pages()
-	links := load_page_links(&pages, &pages_reverse)
-
 	// binary output to write to file
 	bytes := NewBinaryOutput()
 
@@ -178,7 +177,15 @@ func main() {
 		log.Println(err)
 	}
 
-	for from, to := range links {
+	// Write the pages in id order so the same input always gives the same file
+	ids := make([]uint32, 0, len(links))
+	for from := range links {
+		ids = append(ids, from)
+	}
+	sort.Slice(ids, func(i, j int) bool { return ids[i] < ids[j] })
+
+	for _, from := range ids {
+		to := links[from]
 		title := pages_reverse[from]
 
 		bytes := NewBinaryOutput()
@@ -200,5 +207,27 @@ func main() {
 			log.Println(err)
 		}
 	}
+}
+
+func main() {
+	synthetic := flag.String("synthetic", "", "write a generated graph instead of downloading Wikipedia (chain, star, grid or rmat)")
+	size := flag.Int("size", 1000, "number of pages in the generated graph")
+	seed := flag.Int64("seed", 1, "seed for the random generators")
+	dangling := flag.Int("dangling", 0, "number of extra links to ids past the last generated page")
+	flag.Parse()
+
+	if *synthetic != "" {
+		pages_reverse, links, err := generate_graph(*synthetic, *size, *seed, *dangling)
+		if err != nil {
+			log.Fatal(err)
+		}
+		write_data("data.bin", pages_reverse, links)
+		return
+	}
+
+	// get the pages and their links
+	pages, pages_reverse := load_pages()
+	links := load_page_links(&pages, &pages_reverse)
 
+	write_data("data.bin", pages_reverse, links)
 }
@@ -0,0 +1,120 @@
+package main
+
+import (
+	"fmt"
+	"math"
+	"math/rand"
+	"strings"
+)
+
+// Build a generated graph with [size] pages for checking the solver without the real dump
+// Returns the same id -> title and id -> links maps that the Wikipedia loaders produce
+// Every page gets an entry in the links map (even with no links) so every page is written
+func generate_graph(kind string, size int, seed int64, dangling int) (map[uint32]string, map[uint32][]uint32, error) {
+	if size < 1 {
+		return nil, nil, fmt.Errorf("size must be at least 1, got %d", size)
+	}
+
+	pages_reverse := make(map[uint32]string, size)
+	links := make(map[uint32][]uint32, size)
+
+	// Page ids start at 1, titles are zero padded so no title is a prefix of another
+	name := strings.ToUpper(kind[:1]) + kind[1:]
+	for id := uint32(1); id <= uint32(size); id++ {
+		pages_reverse[id] = fmt.Sprintf("%s_%07d", name, id)
+		links[id] = make([]uint32, 0)
+	}
+
+	random := rand.New(rand.NewSource(seed))
+
+	switch kind {
+	case "chain":
+		generate_chain(links, size)
+	case "star":
+		generate_star(links, size)
+	case "grid":
+		generate_grid(links, size)
+	case "rmat":
+		generate_rmat(links, size, random)
+	default:
+		return nil, nil, fmt.Errorf("unknown graph kind %q (expected chain, star, grid or rmat)", kind)
+	}
+
+	// Links to ids that have no page, like links to pages with no links of their own in the real dump
+	for i := 0; i < dangling; i++ {
+		from := uint32(random.Intn(size) + 1)
+		links[from] = append(links[from], uint32(size+1+random.Intn(size)))
+	}
+
+	return pages_reverse, links, nil
+}
+
+// 1 -> 2 -> ... -> size, the longest possible shortest path
+func generate_chain(links map[uint32][]uint32, size int) {
+	for id := uint32(1); id < uint32(size); id++ {
+		links[id] = append(links[id], id+1)
+	}
+}
+
+// Page 1 links to every other page and every other page links back to it
+func generate_star(links map[uint32][]uint32, size int) {
+	for id := uint32(2); id <= uint32(size); id++ {
+		links[1] = append(links[1], id)
+		links[id] = append(links[id], 1)
+	}
+}
+
+// Pages laid out row by row in a square, each linking to its neighbours on all four sides
+func generate_grid(links map[uint32][]uint32, size int) {
+	width := int(math.Ceil(math.Sqrt(float64(size))))
+	for index := 0; index < size; index++ {
+		row, column := index/width, index%width
+		id := uint32(index + 1)
+
+		neighbours := [][2]int{{row - 1, column}, {row + 1, column}, {row, column - 1}, {row, column + 1}}
+		for _, neighbour := range neighbours {
+			if neighbour[0] < 0 || neighbour[1] < 0 || neighbour[1] >= width {
+				continue
+			}
+			other := neighbour[0]*width + neighbour[1]
+			if other >= size {
+				continue
+			}
+			links[id] = append(links[id], uint32(other+1))
+		}
+	}
+}
+
+// R-MAT power law graph with an average of 8 links per page
+// Each link picks a quadrant of the adjacency matrix again and again until it lands on one cell
+func generate_rmat(links map[uint32][]uint32, size int, random *rand.Rand) {
+	const a, b, c = 0.57, 0.19, 0.19
+
+	scale := 0
+	for (1 << scale) < size {
+		scale++
+	}
+
+	for edge := 0; edge < 8*size; edge++ {
+		from, to := 0, 0
+		for bit := 0; bit < scale; bit++ {
+			p := random.Float64()
+			switch {
+			case p < a:
+			case p < a+b:
+				to |= 1 << bit
+			case p < a+b+c:
+				from |= 1 << bit
+			default:
+				from |= 1 << bit
+				to |= 1 << bit
+			}
+		}
+
+		// Cells outside the pages (when size isn't a power of two) and self links are dropped
+		if from >= size || to >= size || from == to {
+			continue
+		}
+		links[uint32(from+1)] = append(links[uint32(from+1)], uint32(to+1))
+	}
+}
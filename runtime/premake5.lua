@@ -193,6 +193,7 @@ project "runtime"
         "Ws2_32",
         "Crypt32",
         "bcrypt",
+        "Advapi32",
         "cpr",
         "curl",
         "opengl32",
@@ -207,3 +208,42 @@ project "runtime"
         "src/**.cpp",
         "src/**.h",
     }
+
+-- Correctness and performance tests for the solver, built without the UI and network libraries
+-- Build with "ninja tests_test" and run runtime/build/bin/test/tests (see test.bat)
+project "tests"
+    kind "ConsoleApp"
+    language "C++"
+    cppdialect "C++20"
+    staticruntime "off"
+    optimize "Speed"
+
+    outputdir = "%{cfg.buildcfg}"
+
+    targetdir ("build/bin/" .. outputdir)
+    objdir ("build/bin-int/" .. outputdir)
+
+    buildoptions {"-Werror", "-Wuninitialized", "-Wextra", "-march=native", "-Wno-return-type", "-Wno-sign-compare", "-Wno-missing-field-initializers"}
+
+    includedirs 
+    {
+        "src",
+        "vendor/levenshtein-sse"
+    }
+
+    links
+    {
+        "Advapi32"
+    }
+
+    files 
+    {
+        "src/wikipedia.cpp",
+        "src/wikipedia.h",
+        "src/large_buffer.cpp",
+        "src/large_buffer.h",
+        "src/mapped_file.cpp",
+        "src/mapped_file.h",
+        "tests/**.cpp",
+        "tests/**.h",
+    }
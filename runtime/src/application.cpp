@@ -177,7 +177,7 @@ void TextOptions(std::string name, std::string& input, PopupState& state, int wi
     int i = 0;
     for (auto* article : state.options)
     {
-        if(ImGui::Selectable(article->title.c_str(), i==state.current, 0, ImVec2(width,0)))
+        if(ImGui::Selectable(article->title.data(), i==state.current, 0, ImVec2(width,0)))
         {
             state.current = i;
             state.open = false;
@@ -189,10 +189,46 @@ void TextOptions(std::string name, std::string& input, PopupState& state, int wi
     ImGui::EndChild();
 }
 
-void Application::Run()
+// Formatted text for one algorithm's results
+// Rebuilt only when a search runs so drawing a frame doesn't allocate
+struct ResultText
+{
+    std::string time;
+    std::vector<std::string> entries;
+};
+
+// Format an algorithm's path and time into its cached text
+void FormatResult(ResultText& text, const std::string& name, const std::vector<const Article*>& path, long long time)
+{
+    text.time = name + " Time: " + std::to_string(time) + "ms";
+    text.entries.clear();
+    text.entries.reserve(path.size());
+    int i = 1;
+    for (auto* article : path)
+    {
+        std::string entry = std::to_string(i) + ". ";
+        entry.append(article->title);
+        text.entries.push_back(std::move(entry));
+        i++;
+    }
+}
+
+// Draw an algorithm's cached results
+void DrawResult(const ResultText& text, bool searched)
+{
+    ImGui::TextUnformatted(text.time.c_str());
+    for (auto& entry : text.entries)
+        ImGui::TextUnformatted(entry.c_str());
+    if (text.entries.size() == 0 && searched)
+    {
+        ImGui::TextUnformatted("No Path Found!");
+    }
+}
+
+void Application::Run(const std::string& data_path, const LoadOptions& options)
 {
     // Load necessary data and assets
-    WikipediaSolver::LoadData("data_collection/data.bin");
+    WikipediaSolver::LoadData(data_path, options);
     AddFont("title", "assets/fonts/JetBrains_Mono/static/JetBrainsMono-Bold.ttf", 28);
     AddFont("subtitle", "assets/fonts/JetBrains_Mono/static/JetBrainsMono-Bold.ttf", 24);
 
@@ -212,6 +248,12 @@ void Application::Run()
     long long bfs_time = 0;
     long long iddfs_time = 0;
 
+    // Text drawn for the algorithm results
+    ResultText bfs_text;
+    ResultText iddfs_text;
+    FormatResult(bfs_text, "BFS", bfs_result, bfs_time);
+    FormatResult(iddfs_text, "IDDFS", iddfs_result, iddfs_time);
+
     bool searched = false;
 
     while (!glfwWindowShouldClose(m_Window))
@@ -261,6 +303,9 @@ void Application::Run()
 
                 iddfs_time = std::chrono::duration_cast<std::chrono::milliseconds>(end-start).count();
                 searched = true;
+
+                FormatResult(bfs_text, "BFS", bfs_result, bfs_time);
+                FormatResult(iddfs_text, "IDDFS", iddfs_result, iddfs_time);
             }
         }
         ImGui::EndChild();
@@ -280,19 +325,7 @@ void Application::Run()
             ImGui::SameLine(0, m_Width/12);
             ImGui::BeginChild("BFS Results", ImVec2(m_Width/3, -1));
             ImGui::PushItemWidth(m_Width/3);
-            std::string bfs_time_result = "BFS Time: " + std::to_string(bfs_time) + "ms";
-            ImGui::Text(bfs_time_result.c_str());
-            int i = 1;
-            for (auto* article : bfs_result)
-            {
-                std::string entry = std::to_string(i) + ". " + article->title.c_str();
-                ImGui::Text(entry.c_str());
-                i++;
-            }
-            if (bfs_result.size() == 0 && searched)
-            {
-                ImGui::Text("No Path Found!");
-            }
+            DrawResult(bfs_text, searched);
             ImGui::PopItemWidth();
             ImGui::EndChild();
 
@@ -300,19 +333,7 @@ void Application::Run()
 
             ImGui::BeginChild("IDDFS Results", ImVec2(m_Width/3, -1));
             ImGui::PushItemWidth(m_Width/3);
-            std::string iddfs_time_result = "IDDFS Time: " + std::to_string(iddfs_time) + "ms";
-            ImGui::Text(iddfs_time_result.c_str());
-            i = 1;
-            for (auto* article : iddfs_result)
-            {
-                std::string entry = std::to_string(i) + ". " + article->title.c_str();
-                ImGui::Text(entry.c_str());
-                i++;
-            }
-            if (iddfs_result.size() == 0 && searched)
-            {
-                ImGui::Text("No Path Found!");
-            }
+            DrawResult(iddfs_text, searched);
             ImGui::PopItemWidth();
             ImGui::EndChild();
 
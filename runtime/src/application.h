@@ -13,6 +13,7 @@
 #include <string>
 
 struct Article;
+struct LoadOptions;
 
 class Application
 {
@@ -21,7 +22,7 @@ public:
     Application(unsigned width, unsigned height);
     ~Application() = default;
 
-    void Run();
+    void Run(const std::string& data_path, const LoadOptions& options);
     void Resize(unsigned width, unsigned height);
 
     void AddFont(const std::string& name, const std::string& path, int size);
@@ -0,0 +1,132 @@
+#include "benchmark.h"
+#include "wikipedia.h"
+#include "large_buffer.h"
+
+#include <iostream>
+#include <chrono>
+#include <random>
+#include <thread>
+#include <vector>
+
+#ifdef __linux__
+    #include <linux/perf_event.h>
+    #include <sys/ioctl.h>
+    #include <sys/syscall.h>
+    #include <unistd.h>
+#endif
+
+// Counts the dTLB load misses of this thread and every thread it starts afterwards
+// A started thread's misses are only added once it has exited
+// Counting isn't available everywhere (other OSes, or perf events being locked down)
+class TLBMissCounter
+{
+public:
+    TLBMissCounter()
+    {
+#ifdef __linux__
+        perf_event_attr attr = {};
+        attr.type = PERF_TYPE_HW_CACHE;
+        attr.size = sizeof(attr);
+        attr.config = PERF_COUNT_HW_CACHE_DTLB | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+        attr.disabled = 1;
+        attr.inherit = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        m_File = syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+#endif
+    }
+
+    ~TLBMissCounter()
+    {
+#ifdef __linux__
+        if (m_File >= 0) close(m_File);
+#endif
+    }
+
+    bool Available() const { return m_File >= 0; }
+
+    void Start()
+    {
+#ifdef __linux__
+        if (m_File >= 0) ioctl(m_File, PERF_EVENT_IOC_ENABLE, 0);
+#endif
+    }
+
+    uint64_t Stop()
+    {
+        uint64_t count = 0;
+#ifdef __linux__
+        if (m_File >= 0)
+        {
+            ioctl(m_File, PERF_EVENT_IOC_DISABLE, 0);
+            if (read(m_File, &count, sizeof(count)) != sizeof(count)) count = 0;
+        }
+#endif
+        return count;
+    }
+private:
+    int m_File = -1;
+};
+
+void RunBenchmark(const BenchmarkOptions& options)
+{
+    std::span<const Article> articles = WikipediaSolver::GetArticles();
+    if (articles.empty())
+        throw std::runtime_error("No articles to benchmark!");
+
+    // Pick every pair up front so the timed part only runs searches
+    std::mt19937 random(options.seed);
+    std::uniform_int_distribution<size_t> pick(0, articles.size() - 1);
+    std::vector<std::pair<const Article*, const Article*>> pairs(options.queries);
+    for (auto& pair : pairs)
+        pair = {&articles[pick(random)], &articles[pick(random)]};
+
+    unsigned workers = std::max(1u, options.workers);
+    unsigned nodes = NumaNodeCount();
+    std::vector<uint64_t> found(workers);
+    std::vector<uint64_t> path_pages(workers);
+
+    TLBMissCounter counter;
+    counter.Start();
+    auto start = std::chrono::high_resolution_clock::now();
+
+    // Plain threads (instead of std::async) so they have exited, and their misses
+    // have been counted, by the time they are joined
+    std::vector<std::thread> threads;
+    for (unsigned w = 0; w < workers; w++)
+    {
+        threads.emplace_back([&, w]() {
+            if (options.pin) PinThreadToNode(w % nodes);
+            for (size_t i = w; i < pairs.size(); i += workers)
+            {
+                auto path = WikipediaSolver::FindPathBFS(pairs[i].first, pairs[i].second);
+                if (path.size() > 0) found[w]++;
+                path_pages[w] += path.size();
+            }
+        });
+    }
+    for (auto& thread : threads)
+        thread.join();
+
+    auto end = std::chrono::high_resolution_clock::now();
+    uint64_t misses = counter.Stop();
+
+    uint64_t total_found = 0;
+    uint64_t total_pages = 0;
+    for (unsigned w = 0; w < workers; w++)
+    {
+        total_found += found[w];
+        total_pages += path_pages[w];
+    }
+
+    double seconds = std::chrono::duration<double>(end - start).count();
+    std::cout << "BFS queries: " << pairs.size() << " (" << total_found << " with a path";
+    if (total_found > 0) std::cout << ", " << (double)total_pages / total_found << " pages on average";
+    std::cout << ")\n";
+    std::cout << "Workers: " << workers << (options.pin ? " pinned across " + std::to_string(nodes) + " NUMA node(s)" : "") << "\n";
+    std::cout << "Time: " << seconds * 1000 << "ms, " << pairs.size() / seconds << " queries/s\n";
+    if (counter.Available())
+        std::cout << "dTLB load misses: " << misses << " (" << (double)misses / pairs.size() << " per query)\n";
+    else
+        std::cout << "dTLB load misses: unavailable on this system\n";
+}
@@ -0,0 +1,20 @@
+#pragma once
+
+#include <cstdint>
+
+// Settings for the BFS throughput benchmark
+struct BenchmarkOptions
+{
+    // Number of random searches to run
+    unsigned queries = 1000;
+    // Number of threads running searches at once
+    unsigned workers = 1;
+    // Pin the workers round robin to the machine's NUMA nodes
+    bool pin = false;
+    // Seed for picking the random pairs of articles (the same seed gives the same pairs)
+    uint32_t seed = 1;
+};
+
+// Runs random BFS searches over the loaded data and prints the throughput
+// and (where the OS exposes it) the number of dTLB misses
+void RunBenchmark(const BenchmarkOptions& options);
@@ -0,0 +1,235 @@
+#include "large_buffer.h"
+
+#include <algorithm>
+#include <bit>
+#include <new>
+#include <thread>
+#include <vector>
+
+#ifdef _WIN32
+    #ifndef NOMINMAX
+        #define NOMINMAX
+    #endif
+    #include <windows.h>
+#else
+    #include <sys/mman.h>
+    #include <unistd.h>
+    #ifdef __linux__
+        #include <sched.h>
+        #include <sys/syscall.h>
+        #include <linux/mempolicy.h>
+        #include <cstdio>
+        #include <fstream>
+        #include <string>
+    #endif
+#endif
+
+static size_t RoundUp(size_t size, size_t alignment)
+{
+    return (size + alignment - 1) / alignment * alignment;
+}
+
+#ifdef _WIN32
+
+// Size of the pieces handed to each NUMA node when interleaving
+constexpr size_t INTERLEAVE_CHUNK = 1 << 21;
+
+unsigned NumaNodeCount()
+{
+    ULONG highest_node = 0;
+    if (!GetNumaHighestNodeNumber(&highest_node)) return 1;
+    return highest_node + 1;
+}
+
+bool PinThreadToNode(unsigned node)
+{
+    GROUP_AFFINITY affinity = {};
+    if (!GetNumaNodeProcessorMaskEx((USHORT)node, &affinity) || affinity.Mask == 0)
+        return false;
+    return SetThreadGroupAffinity(GetCurrentThread(), &affinity, nullptr);
+}
+
+// Large pages need the lock memory privilege, so try to enable it (once) for this process
+static bool EnableLargePages()
+{
+    static bool enabled = [] {
+        HANDLE token;
+        if (!OpenProcessToken(GetCurrentProcess(), TOKEN_ADJUST_PRIVILEGES | TOKEN_QUERY, &token))
+            return false;
+
+        TOKEN_PRIVILEGES privileges = {};
+        privileges.PrivilegeCount = 1;
+        privileges.Privileges[0].Attributes = SE_PRIVILEGE_ENABLED;
+
+        // AdjustTokenPrivileges succeeds even when the privilege isn't granted, so check the last error too
+        bool granted = LookupPrivilegeValueA(nullptr, "SeLockMemoryPrivilege", &privileges.Privileges[0].Luid)
+            && AdjustTokenPrivileges(token, FALSE, &privileges, 0, nullptr, nullptr)
+            && GetLastError() == ERROR_SUCCESS;
+
+        CloseHandle(token);
+        return granted;
+    }();
+    return enabled;
+}
+
+void* AllocateLarge(size_t& size, const MemoryPlacement& placement)
+{
+    // Large pages have to be committed all at once, so they take priority over interleaving
+    if (placement.huge_pages && EnableLargePages())
+    {
+        size_t large_page = GetLargePageMinimum();
+        if (large_page > 0)
+        {
+            size_t rounded = RoundUp(size, large_page);
+            void* data = VirtualAlloc(nullptr, rounded, MEM_RESERVE | MEM_COMMIT | MEM_LARGE_PAGES, PAGE_READWRITE);
+            if (data)
+            {
+                size = rounded;
+                return data;
+            }
+        }
+    }
+
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    size = RoundUp(size, info.dwPageSize);
+
+    char* data = static_cast<char*>(VirtualAlloc(nullptr, size, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE));
+    if (!data) throw std::bad_alloc();
+
+    // Committing only reserves the memory, a physical page is picked from the node of the
+    // thread that first touches it (the preferred node of VirtualAllocExNuma is ignored
+    // when committing inside an existing reservation)
+    // So touch every chunk from a thread pinned to the node that chunk belongs to
+    unsigned nodes = NumaNodeCount();
+    if (placement.interleave && nodes > 1)
+    {
+        std::vector<std::thread> touchers;
+        for (unsigned node = 0; node < nodes; node++)
+        {
+            touchers.emplace_back([=]() {
+                if (!PinThreadToNode(node)) return;
+                for (size_t offset = node * INTERLEAVE_CHUNK; offset < size; offset += nodes * INTERLEAVE_CHUNK)
+                {
+                    size_t end = std::min(offset + INTERLEAVE_CHUNK, size);
+                    for (size_t page = offset; page < end; page += info.dwPageSize)
+                        ((volatile char*)data)[page] = 0;
+                }
+            });
+        }
+        for (auto& toucher : touchers)
+            toucher.join();
+    }
+
+    return data;
+}
+
+void FreeLarge(void* data, size_t)
+{
+    VirtualFree(data, 0, MEM_RELEASE);
+}
+
+#else
+
+constexpr size_t HUGE_PAGE_SIZE = 1 << 21;
+
+#ifdef __linux__
+// Bitmask of the online NUMA nodes, read from sysfs (formatted like "0-1" or "0,2")
+static unsigned long OnlineNodes()
+{
+    unsigned long mask = 0;
+    std::ifstream file("/sys/devices/system/node/online");
+    std::string range;
+    while (std::getline(file, range, ','))
+    {
+        unsigned first = 0, last = 0;
+        int matched = std::sscanf(range.c_str(), "%u-%u", &first, &last);
+        if (matched < 1) continue;
+        if (matched == 1) last = first;
+        for (unsigned node = first; node <= last && node < sizeof(mask) * 8; node++)
+            mask |= 1ul << node;
+    }
+    return mask;
+}
+#endif
+
+unsigned NumaNodeCount()
+{
+#ifdef __linux__
+    unsigned long nodes = OnlineNodes();
+    if (nodes != 0) return std::bit_width(nodes);
+#endif
+    return 1;
+}
+
+bool PinThreadToNode([[maybe_unused]] unsigned node)
+{
+#ifdef __linux__
+    // The node's processors are listed in sysfs in the same range format as the online nodes
+    std::ifstream file("/sys/devices/system/node/node" + std::to_string(node) + "/cpulist");
+    cpu_set_t cpus;
+    CPU_ZERO(&cpus);
+    std::string range;
+    while (std::getline(file, range, ','))
+    {
+        unsigned first = 0, last = 0;
+        int matched = std::sscanf(range.c_str(), "%u-%u", &first, &last);
+        if (matched < 1) continue;
+        if (matched == 1) last = first;
+        for (unsigned cpu = first; cpu <= last && cpu < CPU_SETSIZE; cpu++)
+            CPU_SET(cpu, &cpus);
+    }
+    return CPU_COUNT(&cpus) > 0 && sched_setaffinity(0, sizeof(cpus), &cpus) == 0;
+#else
+    return false;
+#endif
+}
+
+void* AllocateLarge(size_t& size, const MemoryPlacement& placement)
+{
+    void* data = MAP_FAILED;
+    if (placement.huge_pages)
+    {
+        size = RoundUp(size, HUGE_PAGE_SIZE);
+
+        // Explicit huge pages only exist if some were reserved up front
+        // Otherwise fall back to asking for transparent huge pages
+#ifdef MAP_HUGETLB
+        data = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+#endif
+        if (data == MAP_FAILED)
+        {
+            data = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+#ifdef MADV_HUGEPAGE
+            if (data != MAP_FAILED) madvise(data, size, MADV_HUGEPAGE);
+#endif
+        }
+    }
+    else
+    {
+        size = RoundUp(size, sysconf(_SC_PAGESIZE));
+        data = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    }
+
+    if (data == MAP_FAILED) throw std::bad_alloc();
+
+#ifdef __linux__
+    // The policy has to be set before the pages are first touched
+    // If it fails the memory simply stays on the default (local) policy
+    if (placement.interleave)
+    {
+        unsigned long nodes = OnlineNodes();
+        if (std::popcount(nodes) > 1)
+            syscall(SYS_mbind, data, size, MPOL_INTERLEAVE, &nodes, sizeof(nodes) * 8, 0);
+    }
+#endif
+
+    return data;
+}
+
+void FreeLarge(void* data, size_t size)
+{
+    munmap(data, size);
+}
+
+#endif
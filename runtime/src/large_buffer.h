@@ -0,0 +1,79 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <utility>
+
+// Controls where the graph's large arrays are placed in memory
+struct MemoryPlacement
+{
+    // Back the arrays with huge pages (explicit if the OS grants them, otherwise transparent)
+    bool huge_pages = false;
+    // Spread the arrays' pages round robin across all NUMA nodes
+    bool interleave = false;
+};
+
+// Number of NUMA nodes on this machine (1 if it has none or they can't be queried)
+unsigned NumaNodeCount();
+
+// Restrict the calling thread to the processors of one NUMA node
+// Returns false if the node doesn't exist or the thread couldn't be moved
+bool PinThreadToNode(unsigned node);
+
+// Raw page aligned allocations used by LargeBuffer
+// size is rounded up to the page size actually used, and must be passed back when freeing
+void* AllocateLarge(size_t& size, const MemoryPlacement& placement);
+void FreeLarge(void* data, size_t size);
+
+// A fixed size array allocated straight from the OS instead of the heap
+// Used for the big read mostly arrays that every search walks over
+template<typename T>
+class LargeBuffer
+{
+public:
+    LargeBuffer() = default;
+    LargeBuffer(size_t count, const MemoryPlacement& placement)
+        : m_Count(count), m_Bytes(count * sizeof(T))
+    {
+        if (count > 0)
+            m_Data = static_cast<T*>(AllocateLarge(m_Bytes, placement));
+    }
+
+    LargeBuffer(const LargeBuffer&) = delete;
+    LargeBuffer& operator=(const LargeBuffer&) = delete;
+
+    LargeBuffer(LargeBuffer&& other) noexcept
+        : m_Data(std::exchange(other.m_Data, nullptr)),
+          m_Count(std::exchange(other.m_Count, 0)),
+          m_Bytes(std::exchange(other.m_Bytes, 0))
+    {
+    }
+
+    LargeBuffer& operator=(LargeBuffer&& other) noexcept
+    {
+        std::swap(m_Data, other.m_Data);
+        std::swap(m_Count, other.m_Count);
+        std::swap(m_Bytes, other.m_Bytes);
+        return *this;
+    }
+
+    ~LargeBuffer()
+    {
+        if (m_Data) FreeLarge(m_Data, m_Bytes);
+    }
+
+    T* data() { return m_Data; }
+    const T* data() const { return m_Data; }
+    size_t size() const { return m_Count; }
+
+    T& operator[](size_t index) { return m_Data[index]; }
+    const T& operator[](size_t index) const { return m_Data[index]; }
+
+    std::span<T> span() { return {m_Data, m_Count}; }
+    std::span<const T> span() const { return {m_Data, m_Count}; }
+private:
+    T* m_Data = nullptr;
+    size_t m_Count = 0;
+    size_t m_Bytes = 0;
+};
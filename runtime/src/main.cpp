@@ -1,9 +1,94 @@
 #include "application.h"
 #include "wikipedia.h"
+#include "benchmark.h"
 
-// Create and run the app
-int main()
+#include <iostream>
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+// Command line flags:
+//   --data <path>        data file to load (data_collection/data.bin by default)
+//   --huge-pages         back the graph's large arrays with huge pages
+//   --interleave         spread the graph's large arrays across all NUMA nodes
+//   --validate           check every link points at a real page id while loading
+//   --threads <count>    number of threads loading the data (0, the default, uses all cores)
+//   --benchmark <count>  run <count> random BFS searches and print the results instead of opening the window
+//   --workers <count>    number of threads running the benchmark searches
+//   --pin                pin the benchmark threads round robin to the NUMA nodes
+//   --seed <number>      seed for the benchmark's random searches
+int main(int argc, char** argv)
 {
-    Application app;
-    app.Run();
-}
\ No newline at end of file
+    try
+    {
+        std::string data_path = "data_collection/data.bin";
+        LoadOptions load_options;
+        BenchmarkOptions benchmark_options;
+        bool benchmark = false;
+
+        for (int i = 1; i < argc; i++)
+        {
+            std::string flag = argv[i];
+
+            // Flags with a value take the next argument
+            auto value = [&]() -> std::string {
+                if (i+1 >= argc) throw std::runtime_error(flag + " needs a value!");
+                return argv[++i];
+            };
+
+            // Numeric flags have to be a whole number in [min, max] (no sign, nothing after it)
+            auto number = [&](uint64_t min, uint64_t max) -> uint64_t {
+                std::string text = value();
+                auto invalid = [&]() {
+                    return std::runtime_error(flag + " needs a whole number from " + std::to_string(min) + " to " + std::to_string(max) + ", got \"" + text + "\"!");
+                };
+                if (text.empty() || text.find_first_not_of("0123456789") != std::string::npos) throw invalid();
+
+                uint64_t result = 0;
+                try { result = std::stoull(text); }
+                catch (const std::out_of_range&) { throw invalid(); }
+                if (result < min || result > max) throw invalid();
+                return result;
+            };
+
+            if (flag == "--data") data_path = value();
+            else if (flag == "--huge-pages") load_options.placement.huge_pages = true;
+            else if (flag == "--interleave") load_options.placement.interleave = true;
+            else if (flag == "--validate") load_options.validate = true;
+            else if (flag == "--threads") load_options.threads = (unsigned)number(0, 4096);
+            else if (flag == "--benchmark")
+            {
+                benchmark = true;
+                benchmark_options.queries = (unsigned)number(1, 100'000'000);
+            }
+            else if (flag == "--workers") benchmark_options.workers = (unsigned)number(1, 4096);
+            else if (flag == "--pin") benchmark_options.pin = true;
+            else if (flag == "--seed") benchmark_options.seed = (uint32_t)number(0, UINT32_MAX);
+            else throw std::runtime_error("Unknown flag " + flag + "!");
+        }
+
+        // Run the benchmark without opening a window
+        if (benchmark)
+        {
+            auto start = std::chrono::high_resolution_clock::now();
+            WikipediaSolver::LoadData(data_path, load_options);
+            auto end = std::chrono::high_resolution_clock::now();
+
+            std::cout << "Huge pages: " << (load_options.placement.huge_pages ? "on" : "off")
+                      << ", interleave: " << (load_options.placement.interleave ? "on" : "off") << "\n";
+            std::cout << "Load time: " << std::chrono::duration_cast<std::chrono::milliseconds>(end-start).count() << "ms\n";
+
+            RunBenchmark(benchmark_options);
+            return 0;
+        }
+
+        // Create and run the app
+        Application app;
+        app.Run(data_path, load_options);
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+}
@@ -0,0 +1,120 @@
+#include "mapped_file.h"
+
+#include <stdexcept>
+
+#ifdef _WIN32
+    #ifndef NOMINMAX
+        #define NOMINMAX
+    #endif
+    #include <windows.h>
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+// Shrinks [offset, offset + length) to the whole pages inside it, returns false if there are none
+static bool WholePages(size_t& offset, size_t& length, size_t page_size)
+{
+    size_t first = (offset + page_size - 1) / page_size * page_size;
+    size_t last = (offset + length) / page_size * page_size;
+    if (last <= first) return false;
+    offset = first;
+    length = last - first;
+    return true;
+}
+
+#ifdef _WIN32
+
+MappedFile::MappedFile(const std::string& filepath)
+{
+    HANDLE file = CreateFileA(filepath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+        throw std::runtime_error("Failed to open " + filepath + "!");
+    m_File = file;
+
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file, &size))
+    {
+        CloseHandle(file);
+        throw std::runtime_error("Failed to read " + filepath + "!");
+    }
+    m_Size = size.QuadPart;
+
+    // Empty files can't be mapped, they just have no data
+    if (m_Size == 0) return;
+
+    m_Mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (m_Mapping)
+        m_Data = static_cast<const char*>(MapViewOfFile(m_Mapping, FILE_MAP_READ, 0, 0, 0));
+
+    if (!m_Data)
+    {
+        if (m_Mapping) CloseHandle(m_Mapping);
+        CloseHandle(file);
+        throw std::runtime_error("Failed to map " + filepath + "!");
+    }
+}
+
+void MappedFile::Release(size_t offset, size_t length) const
+{
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    if (!m_Data || !WholePages(offset, length, info.dwPageSize)) return;
+
+    // Unlocking pages that were never locked fails, but still removes them from the working set
+    VirtualUnlock(const_cast<char*>(m_Data) + offset, length);
+}
+
+MappedFile::~MappedFile()
+{
+    if (m_Data) UnmapViewOfFile(m_Data);
+    if (m_Mapping) CloseHandle(m_Mapping);
+    if (m_File) CloseHandle(m_File);
+}
+
+#else
+
+MappedFile::MappedFile(const std::string& filepath)
+{
+    int file = open(filepath.c_str(), O_RDONLY);
+    if (file < 0)
+        throw std::runtime_error("Failed to open " + filepath + "!");
+
+    struct stat info;
+    if (fstat(file, &info) != 0)
+    {
+        close(file);
+        throw std::runtime_error("Failed to read " + filepath + "!");
+    }
+    m_Size = info.st_size;
+
+    // Empty files can't be mapped, they just have no data
+    if (m_Size > 0)
+    {
+        void* data = mmap(nullptr, m_Size, PROT_READ, MAP_PRIVATE, file, 0);
+        if (data == MAP_FAILED)
+        {
+            close(file);
+            throw std::runtime_error("Failed to map " + filepath + "!");
+        }
+        m_Data = static_cast<const char*>(data);
+    }
+
+    // The mapping stays valid after the file is closed
+    close(file);
+}
+
+void MappedFile::Release(size_t offset, size_t length) const
+{
+    if (!m_Data || !WholePages(offset, length, sysconf(_SC_PAGESIZE))) return;
+    madvise(const_cast<char*>(m_Data) + offset, length, MADV_DONTNEED);
+}
+
+MappedFile::~MappedFile()
+{
+    if (m_Data) munmap(const_cast<char*>(m_Data), m_Size);
+}
+
+#endif
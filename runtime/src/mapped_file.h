@@ -0,0 +1,31 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+// A read only view of a whole file, mapped into memory instead of copied into it
+// The pages are backed by the file itself, so the OS can drop them again whenever it needs the memory
+class MappedFile
+{
+public:
+    explicit MappedFile(const std::string& filepath);
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    const char* data() const { return m_Data; }
+    size_t size() const { return m_Size; }
+
+    // Tell the OS the bytes in [offset, offset + length) aren't needed for now
+    // so it can drop them from memory (they are read back from the file if touched again)
+    void Release(size_t offset, size_t length) const;
+private:
+    const char* m_Data = nullptr;
+    size_t m_Size = 0;
+#ifdef _WIN32
+    // The file and mapping HANDLEs (kept as void* so windows.h stays out of the header)
+    void* m_File = nullptr;
+    void* m_Mapping = nullptr;
+#endif
+};
@@ -1,8 +1,7 @@
 #include "wikipedia.h"
+#include "mapped_file.h"
 
 #include <levenshtein-sse.hpp>
-#include <nlohmann/json.hpp>
-#include <cpr/cpr.h>
 
 #include <iostream>
 #include <fstream>
@@ -10,8 +9,36 @@
 #include <thread>
 #include <future>
 
+#include <deque>
 #include <queue>
 #include <stack>
+#include <unordered_map>
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstring>
+
+// How much of the data file is consumed before it is handed back to the OS
+constexpr size_t RELEASE_CHUNK_SIZE = 16 << 20;
+
+// Smallest possible page record: id, title length and link count with no title or links
+constexpr size_t MIN_RECORD_SIZE = 3 * sizeof(uint32_t);
+
+// Fewest pages, links or titles handed to a thread of its own while loading
+// Below this, starting the thread costs more than the work it takes over
+constexpr size_t MIN_ITEMS_PER_THREAD = 1 << 14;
+
+// Page ids at or above this are treated as corruption, the id -> article table has
+// an entry for every id up to the largest one (Wikipedia's ids are still below 100 million)
+constexpr uint32_t MAX_PAGE_ID = 1u << 30;
+
+// Initial size of the arena backing a single path search's working memory
+constexpr size_t QUERY_ARENA_SIZE = 1 << 20;
+
+// How much a page's popularity can offset its edit distance in the title search
+// Kept below 1 so popularity only reorders titles that are equally close to the search
+constexpr float POPULARITY_WEIGHT = 0.9f;
 
 // Get the singleton instance
 WikipediaSolver& WikipediaSolver::Get()
@@ -21,78 +48,343 @@ WikipediaSolver& WikipediaSolver::Get()
 }
 
 // Load the data into the singleton
-void WikipediaSolver::LoadData(const std::string& filepath)
+void WikipediaSolver::LoadData(const std::string& filepath, const LoadOptions& options)
 {
     WikipediaSolver& instance = Get();
-    instance.LoadDataImpl(filepath);
+    instance.LoadDataImpl(filepath, options);
+}
+
+// Reads a little endian uint32 that may not be aligned
+static uint32_t ReadUint32(const char* data)
+{
+    uint32_t value;
+    std::memcpy(&value, data, sizeof(uint32_t));
+    return value;
+}
+
+// Error for a data file that doesn't match the expected format
+static std::runtime_error CorruptData(const std::string& filepath, const std::string& problem)
+{
+    return std::runtime_error(filepath + " is corrupt: " + problem);
+}
+
+// Number of threads worth starting for [count] items, at least 1 and at most [threads]
+// Each thread needs MIN_ITEMS_PER_THREAD items, so small loads don't pay for threads that barely run
+static size_t WorkerCount(size_t count, size_t threads)
+{
+    return std::clamp<size_t>(count / MIN_ITEMS_PER_THREAD, 1, std::max<size_t>(threads, 1));
+}
+
+// Splits [0, count) into one range of about the same size per worker (see WorkerCount)
+// Returns the bounds, range i is [bounds[i], bounds[i+1])
+static std::vector<size_t> EvenSplits(size_t count, size_t threads)
+{
+    size_t parts = WorkerCount(count, threads);
+    std::vector<size_t> bounds(parts + 1);
+    for (size_t i = 0; i <= parts; i++)
+        bounds[i] = count * i / parts;
+    return bounds;
+}
+
+// Runs task(first, last) on its own thread for every non empty range in bounds
+// Waits for all of them, then rethrows the first error one of them hit
+// A single range is run on the calling thread
+template<typename Task>
+static void RunInParallel(const std::vector<size_t>& bounds, Task task)
+{
+    if (bounds.size() == 2)
+    {
+        if (bounds[1] > bounds[0]) task(bounds[0], bounds[1]);
+        return;
+    }
+
+    std::vector<std::future<void>> workers;
+    for (size_t i = 0; i + 1 < bounds.size(); i++)
+    {
+        if (bounds[i+1] <= bounds[i]) continue;
+        workers.push_back(std::async(std::launch::async, task, bounds[i], bounds[i+1]));
+    }
+
+    for (auto& worker : workers)
+        worker.wait();
+    for (auto& worker : workers)
+        worker.get();
 }
 
 // Implementation of data loading
-void WikipediaSolver::LoadDataImpl(const std::string& filepath)
+// The file is mapped into memory, then a quick pass over the record headers checks every
+// length and finds where each page's title and links will go
+// With that known, the pages are copied into the graph, the id table is filled
+// and the title index is built by several threads at once
+// The new graph is built off to the side and only replaces the loaded one once every
+// check has passed, so a file that turns out to be corrupt leaves the previous data untouched
+void WikipediaSolver::LoadDataImpl(const std::string& filepath, const LoadOptions& options)
 {
-    // Load the file into a binary stream
-    std::ifstream stream(filepath, std::ios::binary);
+    // Each pass below releases the part of the file it has finished with as it goes,
+    // so only a window of the file is in memory at once
+    MappedFile file(filepath);
+    const char* data = file.data();
+    size_t size = file.size();
 
     // Read in the first 4 bytes (the total number of pages)
-    uint32_t total_count;
-    stream.read((char*)&total_count, sizeof(uint32_t));
-
-    // Allocate the graph size to fit all the pages and then iterate for each page
-    m_Graph.reserve(total_count);
-    for (int _ = 0; _ < total_count; _++)
+    if (size < sizeof(uint32_t))
+        throw CorruptData(filepath, "missing the page count");
+    uint32_t total_count = ReadUint32(data);
+    if (total_count > (size - sizeof(uint32_t)) / MIN_RECORD_SIZE)
+        throw CorruptData(filepath, "page count of " + std::to_string(total_count) + " is larger than the file can hold");
+
+    // Where each page's record starts in the file, and where its title and links go
+    // in the title arena and link array (each with one extra entry for the end of the last page)
+    // The link offsets become the graph's m_Offsets
+    std::vector<size_t> record_offsets;
+    std::vector<size_t> title_offsets;
+    record_offsets.reserve(total_count+1);
+    title_offsets.reserve(total_count+1);
+    LargeBuffer<uint64_t> link_offsets(total_count+1, options.placement);
+
+    // Index pass: hop from record to record, checking that each one fits in the file
+    size_t offset = sizeof(uint32_t);
+    size_t released = 0;
+    size_t title_total = 0;
+    size_t link_total = 0;
+    uint32_t max_id = 0;
+    for (uint32_t page = 0; page < total_count; page++)
     {
-        m_Vertices++;
+        if (offset - released >= RELEASE_CHUNK_SIZE)
+        {
+            file.Release(released, offset - released);
+            released = offset;
+        }
 
-        uint32_t from_id;
-        uint32_t title_length;
-        uint32_t link_count;
+        // Every check compares against the bytes left, so a bad length can't overflow the offset
+        auto where = [&]() { return "page " + std::to_string(page) + " at byte " + std::to_string(offset); };
+        if (size - offset < 2 * sizeof(uint32_t))
+            throw CorruptData(filepath, where() + " is cut off in its header");
 
-        // Read in the id and title length for the current page
-        stream.read((char*)&from_id, sizeof(uint32_t));
-        stream.read((char*)&title_length, sizeof(uint32_t));
+        uint32_t from_id = ReadUint32(data + offset);
+        if (from_id >= MAX_PAGE_ID)
+            throw CorruptData(filepath, where() + " has an id of " + std::to_string(from_id) + " which is too large to be a page id");
 
-        // Add a new page to the graph
-        m_Graph[from_id] = Article{from_id};
+        size_t title_length = ReadUint32(data + offset + sizeof(uint32_t));
+        if (size - offset - 2 * sizeof(uint32_t) < title_length + sizeof(uint32_t))
+            throw CorruptData(filepath, where() + " has a title length of " + std::to_string(title_length) + " that runs past the end of the file");
 
-        // Allocate room in the string for its length
-        std::string& title = m_Graph[from_id].title;
-        title.resize(title_length);
+        size_t link_count = ReadUint32(data + offset + 2 * sizeof(uint32_t) + title_length);
+        if (size - offset - MIN_RECORD_SIZE - title_length < link_count * sizeof(uint32_t))
+            throw CorruptData(filepath, where() + " has a link count of " + std::to_string(link_count) + " that runs past the end of the file");
 
-        // Read the bytes into the string
-        for (int i = 0; i < title_length; i++)
-            stream.read(&title.data()[i], sizeof(char));
+        record_offsets.push_back(offset);
+        title_offsets.push_back(title_total);
+        link_offsets[page] = link_total;
 
+        // Each title gets a null terminator in the arena
+        title_total += title_length + 1;
+        link_total += link_count;
+        offset += MIN_RECORD_SIZE + title_length + link_count * sizeof(uint32_t);
 
-        // Remove underscores and replace them with spaces
-        std::replace(title.begin(), title.end(), '_', ' ');
+        if (from_id > max_id) max_id = from_id;
+    }
+    record_offsets.push_back(offset);
+    title_offsets.push_back(title_total);
+    link_offsets[total_count] = link_total;
+    file.Release(released, offset - released);
+
+    if (offset != size)
+        throw CorruptData(filepath, std::to_string(size - offset) + " unexpected bytes after the last page");
+
+    // Everything is sized up front, so the threads below only fill in their own pages
+    std::vector<Article> articles(total_count);
+    std::vector<TitleEntry> titles(total_count);
+    std::vector<char> title_data(title_total);
+    LargeBuffer<uint32_t> all_links(link_total, options.placement);
+
+    // Copy the pages in [first, last) into the graph
+    auto build = [&](size_t first, size_t last)
+    {
+        size_t released = record_offsets[first];
+        for (size_t i = first; i < last; i++)
+        {
+            if (record_offsets[i] - released >= RELEASE_CHUNK_SIZE)
+            {
+                file.Release(released, record_offsets[i] - released);
+                released = record_offsets[i];
+            }
 
-        // Read in the link count and allocate the links array to the size
-        stream.read((char*)&link_count, sizeof(uint32_t));
-        m_Graph[from_id].links = std::vector<uint32_t>(link_count);
+            const char* record = data + record_offsets[i];
+            uint32_t from_id = ReadUint32(record);
 
-        m_Edges += link_count;
+            // Copy the title into the arena, replacing underscores with spaces
+            size_t title_length = title_offsets[i+1] - title_offsets[i] - 1;
+            char* title = title_data.data() + title_offsets[i];
+            const char* title_start = record + 2 * sizeof(uint32_t);
+            std::replace_copy(title_start, title_start + title_length, title, '_', ' ');
+            title[title_length] = '\0';
 
-        // Read all the link bytes directly into the link array
-        stream.read((char*)&m_Graph[from_id].links[0], sizeof(uint32_t)*link_count);
+            // Copy all the link bytes directly into the link array
+            size_t link_count = link_offsets[i+1] - link_offsets[i];
+            uint32_t* links = all_links.data() + link_offsets[i];
+            if (link_count > 0)
+                std::memcpy(links, title_start + title_length + sizeof(uint32_t), link_count * sizeof(uint32_t));
 
-        if (from_id > m_MaxID) m_MaxID = from_id;
+            if (options.validate)
+            {
+                for (size_t j = 0; j < link_count; j++)
+                {
+                    if (links[j] > max_id)
+                        throw CorruptData(filepath, "page id " + std::to_string(from_id) + " links to id " + std::to_string(links[j]) + " which is past the largest page id");
+                }
+            }
 
-        // Add the string and id to the title array for searching
-        m_Titles.emplace_back(title, from_id);
+            std::string_view title_view(title, title_length);
+            articles[i] = Article{from_id, title_view};
+            titles[i] = {title_view, from_id, 0.0f};
+        }
+        file.Release(released, record_offsets[last] - released);
+    };
+
+    // Split the pages so each thread gets about the same number of bytes to copy
+    // (never more threads than the pages are worth, however many were asked for)
+    size_t threads = options.threads > 0 ? options.threads : std::max(1u, std::thread::hardware_concurrency());
+    size_t builders = WorkerCount(total_count, threads);
+    std::vector<size_t> page_bounds(builders + 1, total_count);
+    page_bounds[0] = 0;
+    for (size_t t = 1; t < builders; t++)
+    {
+        size_t split = sizeof(uint32_t) + (size - sizeof(uint32_t)) / builders * t;
+        page_bounds[t] = std::lower_bound(record_offsets.begin(), record_offsets.end() - 1, split) - record_offsets.begin();
     }
+    RunInParallel(page_bounds, build);
+
+    // Map every page id to its article, duplicate ids mean the data is broken
+    // Two threads can meet on the same id, so each entry is claimed with a compare and swap
+    LargeBuffer<uint32_t> slots(size_t(max_id)+1, options.placement);
+    RunInParallel(EvenSplits(slots.size(), threads), [&](size_t first, size_t last) {
+        std::fill(slots.data() + first, slots.data() + last, UINT32_MAX);
+    });
+    RunInParallel(EvenSplits(total_count, threads), [&](size_t first, size_t last) {
+        for (size_t i = first; i < last; i++)
+        {
+            uint32_t from_id = articles[i].id;
+            uint32_t empty = UINT32_MAX;
+            if (!std::atomic_ref<uint32_t>(slots[from_id]).compare_exchange_strong(empty, (uint32_t)i))
+                throw CorruptData(filepath, "page id " + std::to_string(from_id) + " appears more than once");
+        }
+    });
+
+    BuildTitleIndex(titles, all_links.span(), max_id, threads);
+
+    // Nothing below can fail, swap the new graph in (the old one is freed along with the locals)
+    m_Vertices = total_count;
+    m_Edges = link_total;
+    m_MaxID = max_id;
+    m_Articles = std::move(articles);
+    m_Slots = std::move(slots);
+    m_Offsets = std::move(link_offsets);
+    m_Links = std::move(all_links);
+    m_TitleData = std::move(title_data);
+    m_Titles = std::move(titles);
+}
+
+// Returns the article with the given id, or nullptr if no page has it
+// (links can point to pages that have no entry of their own)
+const Article* WikipediaSolver::FindArticle(uint32_t id) const
+{
+    if (id > m_MaxID || m_Slots[id] == UINT32_MAX) return nullptr;
+    return &m_Articles[m_Slots[id]];
+}
 
-    // If all the data was not loaded throw an error
-    if (m_Graph.size() != total_count)
-        throw std::runtime_error("Failed to load in all data!");
+// Returns the links of the page with the given id (none if no page has it)
+std::span<const uint32_t> WikipediaSolver::Links(uint32_t id) const
+{
+    if (id > m_MaxID || m_Slots[id] == UINT32_MAX) return {};
+    uint32_t slot = m_Slots[id];
+    return m_Links.span().subspan(m_Offsets[slot], m_Offsets[slot+1] - m_Offsets[slot]);
+}
+
+// Returns the lowercase first character of a title (the bucket it is searched in)
+static unsigned char TitleBucket(std::string_view title)
+{
+    if (title.empty()) return 0;
+    return (unsigned char)std::tolower((unsigned char)title[0]);
+}
+
+// Scores each title by its in-degree and sorts the title index
+// Titles are grouped by their first character and ordered by popularity inside each group
+void WikipediaSolver::BuildTitleIndex(std::vector<TitleEntry>& titles, std::span<const uint32_t> links, uint32_t max_id, size_t threads)
+{
+    // Count the number of pages linking to each page
+    // Every thread takes a share of the links and tracks the largest count it produced
+    std::vector<uint32_t> in_degree(size_t(max_id)+1);
+    std::atomic<uint32_t> max_degree = 0;
+    RunInParallel(EvenSplits(links.size(), threads), [&](size_t first, size_t last) {
+        uint32_t local_max = 0;
+        for (size_t i = first; i < last; i++)
+        {
+            uint32_t link = links[i];
+            if (link > max_id) continue;
+            uint32_t degree = std::atomic_ref<uint32_t>(in_degree[link]).fetch_add(1, std::memory_order_relaxed) + 1;
+            local_max = std::max(local_max, degree);
+        }
+
+        uint32_t seen = max_degree.load();
+        while (seen < local_max && !max_degree.compare_exchange_weak(seen, local_max));
+    });
+
+    // Use a log scale so a few huge hub pages don't flatten everyone else's score
+    float normalizer = std::log2(1.0f + max_degree);
+    RunInParallel(EvenSplits(titles.size(), threads), [&](size_t first, size_t last) {
+        for (size_t i = first; i < last; i++)
+            titles[i].popularity = normalizer > 0.0f ? std::log2(1.0f + in_degree[titles[i].id]) / normalizer : 0.0f;
+    });
+
+    // Group the titles by bucket (a stable counting sort)
+    std::vector<size_t> bucket_bounds(257);
+    for (auto& entry : titles)
+        bucket_bounds[TitleBucket(entry.title) + 1]++;
+    for (size_t b = 1; b < bucket_bounds.size(); b++)
+        bucket_bounds[b] += bucket_bounds[b-1];
+
+    std::vector<TitleEntry> grouped(titles.size());
+    std::vector<size_t> next = bucket_bounds;
+    for (auto& entry : titles)
+        grouped[next[TitleBucket(entry.title)]++] = entry;
+    titles = std::move(grouped);
+
+    // Then sort the buckets by popularity, each thread takes the next unsorted bucket
+    // (largest first, so one huge bucket doesn't end up last)
+    std::vector<int> order(256);
+    for (int b = 0; b < 256; b++) order[b] = b;
+    std::sort(order.begin(), order.end(), [&](int a, int b) {
+        return bucket_bounds[a+1] - bucket_bounds[a] > bucket_bounds[b+1] - bucket_bounds[b];
+    });
+
+    std::atomic<size_t> next_bucket = 0;
+    size_t sorters = WorkerCount(titles.size(), threads);
+    std::vector<size_t> sorter_bounds(sorters + 1);
+    for (size_t s = 0; s <= sorters; s++) sorter_bounds[s] = s;
+    RunInParallel(sorter_bounds, [&](size_t, size_t) {
+        for (size_t i = next_bucket++; i < order.size(); i = next_bucket++)
+        {
+            int b = order[i];
+            std::sort(titles.begin() + bucket_bounds[b], titles.begin() + bucket_bounds[b+1], [](const TitleEntry& a, const TitleEntry& b) {
+                if (a.popularity != b.popularity) return a.popularity > b.popularity;
+                return a.id < b.id;
+            });
+        }
+    });
 }
 
 // Searches for the best [limit] matches in the titles
+// A title's score is its edit distance minus a bonus for how popular it is (lower is better)
 std::vector<const Article*> WikipediaSolver::SearchTitle(const std::string& search_string, int limit)
 {
     std::vector<const Article*> result;
+    if (search_string.empty() || limit <= 0) return result;
 
+    // Max heap of the [limit] best scores seen so far, the worst one is on top
     typedef std::pair<float, uint32_t> Score;
-    std::priority_queue<Score> queue;
+    std::vector<Score> heap;
+    heap.reserve(limit);
 
     auto lowercase_search = std::string(search_string);
     std::transform(lowercase_search.begin(), lowercase_search.end(), lowercase_search.begin(),
@@ -100,38 +392,55 @@ std::vector<const Article*> WikipediaSolver::SearchTitle(const std::string& sear
 
     WikipediaSolver& instance = Get();
 
-    // Iterate through each title
-    // If the first character matches [both forced into lowercase]
-    // Then calculate the levenshtein distance between the search and current title
-    // Add the title to a heap which keeps track of the [limit] lowest scores
-    for (auto& pair : instance.m_Titles)
+    // Only titles starting with the same character [both forced into lowercase] are candidates
+    // The index is sorted by that character, so find the range with two binary searches
+    unsigned char bucket = lowercase_search[0];
+    auto begin = std::partition_point(instance.m_Titles.begin(), instance.m_Titles.end(),
+        [&](const TitleEntry& entry){ return TitleBucket(entry.title) < bucket; });
+    auto end = std::partition_point(begin, instance.m_Titles.end(),
+        [&](const TitleEntry& entry){ return TitleBucket(entry.title) == bucket; });
+
+    // Reused buffer for the lowercase start of each title
+    std::string lowercase_prefix(search_string.size(), '\0');
+
+    // Iterate through the candidates from most to least popular
+    // Calculate the levenshtein distance between the search and the start of the title
+    // and keep the [limit] lowest scores in the heap
+    for (auto it = begin; it != end; it++)
     {
-        if (std::tolower(pair.first[0]) != lowercase_search[0]) continue;
-        if (pair.first.length() < search_string.length()) continue;
+        const TitleEntry& entry = *it;
 
-        std::string lowercase_title = std::string(pair.first);
-        std::transform(lowercase_title.begin(), lowercase_title.end(), lowercase_title.begin(),
+        // The best any remaining title can do is an exact match with this title's popularity
+        // Once that can't beat the worst score in a full heap, stop scanning
+        float bonus = POPULARITY_WEIGHT * entry.popularity;
+        if (heap.size() == limit && heap.front().first <= -bonus)
+            break;
+
+        if (entry.title.length() < search_string.length()) continue;
+
+        std::transform(entry.title.begin(), entry.title.begin() + search_string.size(), lowercase_prefix.begin(),
         [](unsigned char c){ return std::tolower(c); });
 
-        float score = (float)levenshteinSSE::levenshtein(lowercase_search.begin(), lowercase_search.end(), lowercase_title.begin(), lowercase_title.begin() + search_string.size());
-        if (queue.size() == limit && score > queue.top().first)
-            continue;
-        queue.emplace(score, pair.second);
-        if (queue.size() > limit)
-            queue.pop();
-    }
+        float score = (float)levenshteinSSE::levenshtein(lowercase_search.begin(), lowercase_search.end(), lowercase_prefix.begin(), lowercase_prefix.end()) - bonus;
 
-    // Iterate through each title in the heap and add 
-    // the corresponding title to the result array
-    result.resize(queue.size());
-    int index = result.size()-1;
-    while (!queue.empty())
-    {
-        auto [score, key] = queue.top();
-        result[index--] = &instance.m_Graph[key];
-        queue.pop();
+        // Ties go to the title seen first (the more popular one)
+        if (heap.size() == limit)
+        {
+            if (score >= heap.front().first) continue;
+            std::pop_heap(heap.begin(), heap.end());
+            heap.pop_back();
+        }
+        heap.emplace_back(score, entry.id);
+        std::push_heap(heap.begin(), heap.end());
     }
 
+    // Order the [limit] results from best to worst and add
+    // the corresponding article to the result array
+    std::sort_heap(heap.begin(), heap.end());
+    result.reserve(heap.size());
+    for (auto [score, key] : heap)
+        result.push_back(instance.FindArticle(key));
+
     return result;
 }
 
@@ -140,11 +449,15 @@ std::vector<const Article*> WikipediaSolver::FindPathBFSImpl(uint32_t from, uint
 {
     std::vector<const Article*> path;
 
-    std::queue<uint32_t> queue;
-    std::vector<bool> visited(m_MaxID+1);
+    // All of the search's working memory comes from one arena
+    // that is thrown away in one go when the query finishes
+    std::pmr::monotonic_buffer_resource arena(QUERY_ARENA_SIZE);
+
+    std::queue<uint32_t, std::pmr::deque<uint32_t>> queue(&arena);
+    std::pmr::vector<bool> visited(size_t(m_MaxID)+1, false, &arena);
 
     // Keeps track of where a vertex got added from (to find the path later)
-    std::unordered_map<uint32_t, uint32_t> backtrack;
+    std::pmr::unordered_map<uint32_t, uint32_t> backtrack(&arena);
 
     // Start at the from vertex
     queue.push(from);
@@ -169,9 +482,11 @@ std::vector<const Article*> WikipediaSolver::FindPathBFSImpl(uint32_t from, uint
 
             // Add each link of the current vertex to the queue
             // Add where it came from to the backtrack map
-			for (uint32_t link : m_Graph[current].links)
+            // (pages without an entry have no links, and ids past the largest page
+            // can never be the target, so skip them)
+			for (uint32_t link : Links(current))
             {
-                if (visited[link]) continue;
+                if (link > m_MaxID || visited[link]) continue;
                 queue.push(link);
                 visited[link] = true;
                 backtrack[link] = current;
@@ -188,7 +503,7 @@ std::vector<const Article*> WikipediaSolver::FindPathBFSImpl(uint32_t from, uint
     uint32_t current = to;
     for (int i = 1; i <= depth; i++)
     {   
-        path[depth-i] = &m_Graph.at(current);
+        path[depth-i] = FindArticle(current);
         current = backtrack[current];
     }
 
@@ -214,24 +529,30 @@ std::vector<const Article*> WikipediaSolver::FindPathBFS(const std::string& from
 }
 
 
-std::vector<const Article*> WikipediaSolver::DepthLimitedSearch(uint32_t from, uint32_t to, int limit)
+std::vector<const Article*> WikipediaSolver::DepthLimitedSearch(uint32_t from, uint32_t to, int limit, std::pmr::memory_resource* arena)
 {
     std::vector<const Article*> result;
 
     bool found = false;
-    std::stack<uint32_t> stack;
-    std::vector<bool> visited(m_MaxID+1);
+    std::stack<uint32_t, std::pmr::deque<uint32_t>> stack(arena);
+
+    // Keeps track of the vertices reached so far (one bit per page id)
+    std::pmr::vector<bool> visited(size_t(m_MaxID)+1, false, arena);
 
-    // Keeps track of a vertex's depth and previous vertex (for backtracking)
-    std::unordered_map<uint32_t, std::pair<uint32_t, uint32_t>> info;
+    // Shallowest depth each reached vertex was found at and the vertex before it (for backtracking)
+    // Only reached vertices get an entry, so this stays as small as the search itself
+    struct VisitInfo { uint32_t depth; uint32_t parent; };
+    std::pmr::unordered_map<uint32_t, VisitInfo> info(arena);
 
     // Simple DFS algorithm on a graph
     // Start at from and add each child to a stack
     // Pull the top and repeat
     // However, if a vertex that's being added is too deep, it will not be appended
+    // A vertex is added again if a shallower route to it turns up, otherwise the first
+    // (possibly deeper) route found could hide a path that fits inside the limit
     stack.push(from);
     visited[from] = true;
-    info[from] = {0, 0};
+    info[from] = {0, from};
 
     while (!stack.empty())
     {
@@ -243,26 +564,37 @@ std::vector<const Article*> WikipediaSolver::DepthLimitedSearch(uint32_t from, u
             break;
         }
 
-        for (uint32_t link : m_Graph[current].links)
+        uint32_t next_depth = info[current].depth+1;
+        if (next_depth >= (uint32_t)limit) continue;
+
+        // Pages without an entry have no links to follow
+        for (uint32_t link : Links(current))
         {
-            // If the vertex is unvisited and not too deep, add it to the stack
-            if (!visited[link] && info[current].first+1 <limit) {
+            if (link > m_MaxID) continue;
+
+            // If the vertex hasn't been reached this shallow before, add it to the stack
+            if (!visited[link]) {
+                visited[link] = true;
+                info[link] = {next_depth, current};
+                stack.push(link);
+            }
+            else if (VisitInfo& seen = info[link]; next_depth < seen.depth) {
+                seen = {next_depth, current};
                 stack.push(link);
-                visited[link] = 1;
-                info[link] = {info[current].first+1, current};
             }
         }
     }
     
-    // Use the info map to retrace the BFS' steps
+    // Use the backtrack map to retrace the DFS' steps
     // And insert the path into a vector (in reverse)
     if (found) {
-        result.resize(limit);
+        int length = info[to].depth+1;
+        result.resize(length);
         uint32_t current = to;
-        for (int i = 1; i <= limit; i++)
+        for (int i = 1; i <= length; i++)
         {   
-            result[limit-i] = &m_Graph.at(current);
-            current = info[current].second;
+            result[length-i] = FindArticle(current);
+            current = info[current].parent;
         }
     }
 
@@ -272,12 +604,16 @@ std::vector<const Article*> WikipediaSolver::DepthLimitedSearch(uint32_t from, u
 // Implementation of the IDDFS Algorithm
 std::vector<const Article*> WikipediaSolver::FindPathIDDFSImpl(uint32_t from, uint32_t to)
 {
+    // Every depth limited search shares one arena, emptied between iterations
+    std::pmr::monotonic_buffer_resource arena(QUERY_ARENA_SIZE);
+
     // Increase the limit and call a DFS up to that limit each iteration
-    // Max depth is 10
-    for (int i = 0; i < 10; i++)
+    // Max depth is MAX_IDDFS_DEPTH pages
+    for (int i = 1; i <= MAX_IDDFS_DEPTH; i++)
     {
-        auto res = DepthLimitedSearch(from, to, i);
+        auto res = DepthLimitedSearch(from, to, i, &arena);
         if (res.size() > 0) return res;
+        arena.release();
     }
 
    return std::vector<const Article*>();
@@ -300,4 +636,22 @@ std::vector<const Article*> WikipediaSolver::FindPathIDDFS(const std::string& fr
 
     // Call the IDDFS impl on the two closest articles
     return instance.FindPathIDDFSImpl(from_results[0]->id, to_results[0]->id);
+}
+
+// Get all of the loaded articles
+std::span<const Article> WikipediaSolver::GetArticles()
+{
+    return Get().m_Articles;
+}
+
+// Static Function to Run the BFS between two known articles
+std::vector<const Article*> WikipediaSolver::FindPathBFS(const Article* from, const Article* to)
+{
+    return Get().FindPathBFSImpl(from->id, to->id);
+}
+
+// Static Function to Run the IDDFS between two known articles
+std::vector<const Article*> WikipediaSolver::FindPathIDDFS(const Article* from, const Article* to)
+{
+    return Get().FindPathIDDFSImpl(from->id, to->id);
 }
\ No newline at end of file
@@ -1,13 +1,40 @@
+#include "large_buffer.h"
+
+#include <memory_resource>
+#include <span>
 #include <string>
-#include <unordered_map>
+#include <string_view>
 #include <vector>
 
 // Article contains all of a pages information
+// The title points into the solver's title arena and is null terminated there,
+// so title.data() can be handed straight to C style APIs
+// Its links live in the solver's adjacency arrays (see WikipediaSolver::Links)
 struct Article
 {
     uint32_t id;
-    std::string title;
-    std::vector<uint32_t> links;
+    std::string_view title;
+};
+
+// TitleEntry is a single row of the title search index
+// popularity is a static score in [0, 1] derived from the page's in-degree
+struct TitleEntry
+{
+    std::string_view title;
+    uint32_t id;
+    float popularity;
+};
+
+// Options for loading the data file
+struct LoadOptions
+{
+    // Where the graph's large arrays are placed in memory
+    MemoryPlacement placement;
+    // Also check that every link points inside the range of page ids
+    // Off by default since real dumps can link to pages that have no entry of their own
+    bool validate = false;
+    // Number of threads used to build the graph (0 uses one per core)
+    unsigned threads = 0;
 };
 
 // Singleton Design Structure
@@ -15,27 +42,48 @@ struct Article
 class WikipediaSolver
 {
 public:
+    // Longest path (in pages) FindPathIDDFS will look for, longer paths are reported as not found
+    static constexpr int MAX_IDDFS_DEPTH = 10;
+
     WikipediaSolver(const WikipediaSolver&) = delete;
 
     static WikipediaSolver& Get();
 
-    static void LoadData(const std::string& filepath);
+    static void LoadData(const std::string& filepath, const LoadOptions& options = {});
 
     static std::vector<const Article*> SearchTitle(const std::string& search_string, int limit);
     
     static std::vector<const Article*> FindPathBFS(const std::string& from, const std::string& to);
     static std::vector<const Article*> FindPathIDDFS(const std::string& from, const std::string& to);
+
+    // Every loaded article (in file order), and searches between two of them
+    // that skip the title search (used by the benchmark)
+    static std::span<const Article> GetArticles();
+    static std::vector<const Article*> FindPathBFS(const Article* from, const Article* to);
+    static std::vector<const Article*> FindPathIDDFS(const Article* from, const Article* to);
 private:
     WikipediaSolver() = default;
 
-    void LoadDataImpl(const std::string& filepath);
+    void LoadDataImpl(const std::string& filepath, const LoadOptions& options);
+    static void BuildTitleIndex(std::vector<TitleEntry>& titles, std::span<const uint32_t> links, uint32_t max_id, size_t threads);
+    const Article* FindArticle(uint32_t id) const;
+    std::span<const uint32_t> Links(uint32_t id) const;
     std::vector<const Article*> FindPathBFSImpl(uint32_t from, uint32_t to);
     std::vector<const Article*> FindPathIDDFSImpl(uint32_t from, uint32_t to);
-    std::vector<const Article*> DepthLimitedSearch(uint32_t from, uint32_t to, int limit);
+    std::vector<const Article*> DepthLimitedSearch(uint32_t from, uint32_t to, int limit, std::pmr::memory_resource* arena);
 private:
     uint32_t m_Vertices = 0;
     uint32_t m_Edges = 0;
     uint32_t m_MaxID = 0;
-    std::unordered_map<uint32_t, Article> m_Graph;
-    std::vector<std::pair<std::string, uint32_t>> m_Titles;
+    // Articles in file order, m_Slots maps a page id to its index in m_Articles
+    std::vector<Article> m_Articles;
+    LargeBuffer<uint32_t> m_Slots;
+    // Every article's links back to back, the links of the article in slot i
+    // are m_Links[m_Offsets[i]] up to m_Links[m_Offsets[i+1]]
+    // Searches only walk m_Slots, m_Offsets and m_Links, never m_Articles
+    LargeBuffer<uint64_t> m_Offsets;
+    LargeBuffer<uint32_t> m_Links;
+    // A vector rather than a string so moving it never moves the bytes the titles point at
+    std::vector<char> m_TitleData;
+    std::vector<TitleEntry> m_Titles;
 };
\ No newline at end of file
@@ -0,0 +1,152 @@
+#include "graph_generator.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <stdexcept>
+
+size_t GeneratedGraph::AddPage(uint32_t id, const std::string& title)
+{
+    ids.push_back(id);
+    titles.push_back(title);
+    links.emplace_back();
+    return ids.size() - 1;
+}
+
+// Pages 1..size named after the generator, without any links yet
+static GeneratedGraph NumberedPages(const std::string& name, uint32_t size)
+{
+    GeneratedGraph graph;
+    char title[64];
+    for (uint32_t id = 1; id <= size; id++)
+    {
+        std::snprintf(title, sizeof(title), "%s_%07u", name.c_str(), id);
+        graph.AddPage(id, title);
+    }
+    return graph;
+}
+
+GeneratedGraph GenerateChain(uint32_t size)
+{
+    GeneratedGraph graph = NumberedPages("Chain", size);
+    for (uint32_t id = 1; id < size; id++)
+        graph.links[id-1].push_back(id+1);
+    return graph;
+}
+
+GeneratedGraph GenerateStar(uint32_t size)
+{
+    GeneratedGraph graph = NumberedPages("Star", size);
+    for (uint32_t id = 2; id <= size; id++)
+    {
+        graph.links[0].push_back(id);
+        graph.links[id-1].push_back(1);
+    }
+    return graph;
+}
+
+GeneratedGraph GenerateGrid(uint32_t size)
+{
+    GeneratedGraph graph = NumberedPages("Grid", size);
+    int64_t width = (int64_t)std::ceil(std::sqrt((double)size));
+
+    for (int64_t index = 0; index < size; index++)
+    {
+        int64_t row = index / width, column = index % width;
+        int64_t neighbours[4][2] = {{row-1, column}, {row+1, column}, {row, column-1}, {row, column+1}};
+        for (auto& neighbour : neighbours)
+        {
+            if (neighbour[0] < 0 || neighbour[1] < 0 || neighbour[1] >= width) continue;
+            int64_t other = neighbour[0] * width + neighbour[1];
+            if (other >= size) continue;
+            graph.links[index].push_back((uint32_t)other + 1);
+        }
+    }
+    return graph;
+}
+
+GeneratedGraph GenerateRMAT(uint32_t size, uint32_t seed)
+{
+    constexpr double a = 0.57, b = 0.19, c = 0.19;
+
+    GeneratedGraph graph = NumberedPages("Rmat", size);
+    std::mt19937 random(seed);
+    std::uniform_real_distribution<double> probability(0.0, 1.0);
+
+    int scale = 0;
+    while ((uint64_t(1) << scale) < size) scale++;
+
+    // Each link picks a quadrant of the adjacency matrix again and again until it lands on one cell
+    for (uint64_t edge = 0; edge < uint64_t(8) * size; edge++)
+    {
+        uint64_t from = 0, to = 0;
+        for (int bit = 0; bit < scale; bit++)
+        {
+            double p = probability(random);
+            if (p < a) continue;
+            else if (p < a + b) to |= uint64_t(1) << bit;
+            else if (p < a + b + c) from |= uint64_t(1) << bit;
+            else
+            {
+                from |= uint64_t(1) << bit;
+                to |= uint64_t(1) << bit;
+            }
+        }
+
+        // Cells outside the pages (when size isn't a power of two) and self links are dropped
+        if (from >= size || to >= size || from == to) continue;
+        graph.links[from].push_back((uint32_t)to + 1);
+    }
+    return graph;
+}
+
+GeneratedGraph GenerateGraph(const std::string& kind, uint32_t size, uint32_t seed)
+{
+    if (kind == "chain") return GenerateChain(size);
+    if (kind == "star") return GenerateStar(size);
+    if (kind == "grid") return GenerateGrid(size);
+    if (kind == "rmat") return GenerateRMAT(size, seed);
+    throw std::runtime_error("Unknown graph kind " + kind + "!");
+}
+
+void AddDanglingLinks(GeneratedGraph& graph, uint32_t count, uint32_t seed)
+{
+    uint32_t max_id = *std::max_element(graph.ids.begin(), graph.ids.end());
+    std::mt19937 random(seed);
+    std::uniform_int_distribution<size_t> from(0, graph.size() - 1);
+    std::uniform_int_distribution<uint32_t> to(max_id + 1, max_id + (uint32_t)graph.size());
+
+    for (uint32_t i = 0; i < count; i++)
+        graph.links[from(random)].push_back(to(random));
+}
+
+static void WriteUint32(std::ofstream& file, uint32_t value)
+{
+    file.write(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+std::string WriteDataFile(const GeneratedGraph& graph, const std::string& name)
+{
+    std::string path = (std::filesystem::temp_directory_path() / name).string();
+
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) throw std::runtime_error("Failed to create " + path + "!");
+
+    // Same layout the loader reads: page count, then id, title length, title, link count and links per page
+    WriteUint32(file, (uint32_t)graph.size());
+    for (size_t i = 0; i < graph.size(); i++)
+    {
+        WriteUint32(file, graph.ids[i]);
+        WriteUint32(file, (uint32_t)graph.titles[i].size());
+        file.write(graph.titles[i].data(), graph.titles[i].size());
+        WriteUint32(file, (uint32_t)graph.links[i].size());
+        for (uint32_t link : graph.links[i])
+            WriteUint32(file, link);
+    }
+
+    if (!file) throw std::runtime_error("Failed to write " + path + "!");
+    return path;
+}
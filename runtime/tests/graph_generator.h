@@ -0,0 +1,44 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// A graph built in memory by the tests and written out in the data.bin format
+// Mirrors data_collection's -synthetic generators so both produce the same kinds of graphs
+struct GeneratedGraph
+{
+    // Page ids, titles and outgoing links, all indexed the same way
+    std::vector<uint32_t> ids;
+    std::vector<std::string> titles;
+    std::vector<std::vector<uint32_t>> links;
+
+    size_t size() const { return ids.size(); }
+
+    // Adds a page and returns its index
+    size_t AddPage(uint32_t id, const std::string& title);
+};
+
+// Every generator creates pages 1..size with zero padded titles like "Chain_0000001"
+// so page id i is always at index i-1
+
+// 1 -> 2 -> ... -> size, the longest possible shortest path
+GeneratedGraph GenerateChain(uint32_t size);
+
+// Page 1 links to every other page and every other page links back to it
+GeneratedGraph GenerateStar(uint32_t size);
+
+// Pages laid out row by row in a square, each linking to its neighbours on all four sides
+GeneratedGraph GenerateGrid(uint32_t size);
+
+// R-MAT power law graph with an average of 8 links per page (minus dropped self links)
+GeneratedGraph GenerateRMAT(uint32_t size, uint32_t seed);
+
+// Builds one of the above by name (chain, star, grid or rmat)
+GeneratedGraph GenerateGraph(const std::string& kind, uint32_t size, uint32_t seed);
+
+// Adds [count] links to ids past the largest page id, like links to missing pages in the real dump
+void AddDanglingLinks(GeneratedGraph& graph, uint32_t count, uint32_t seed);
+
+// Writes the graph to [name] in the temp directory and returns the full path
+std::string WriteDataFile(const GeneratedGraph& graph, const std::string& name);
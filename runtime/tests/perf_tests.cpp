@@ -0,0 +1,93 @@
+#include "test.h"
+#include "graph_generator.h"
+#include "wikipedia.h"
+
+#include <chrono>
+#include <iomanip>
+#include <random>
+
+// Time limits for each generator and size, so a change that makes loading or searching
+// much slower fails the suite instead of going unnoticed
+// Set to roughly 10x what an optimized build took on one core when they were recorded
+// (with a floor of 20ms to load and 0.5ms a search, so tiny graphs don't fail on timer noise)
+// Loads use PERF_LOAD_THREADS threads, so the limits track the code and not the machine's core count
+struct PerfThreshold
+{
+    const char* kind;
+    uint32_t size;
+    // Whole LoadData call
+    double max_load_ms;
+    // Average over PERF_QUERIES random pairs
+    double max_bfs_ms;
+    double max_iddfs_ms;
+};
+
+constexpr PerfThreshold PERF_THRESHOLDS[] = {
+    // kind     size    load    bfs     iddfs
+    {"chain",   1000,   20,     0.5,    0.5},
+    {"chain",   10000,  20,     1.5,    0.5},
+    {"chain",   100000, 150,    15,     0.5},
+    {"star",    1000,   20,     0.5,    0.5},
+    {"star",    10000,  20,     2.5,    3},
+    {"star",    100000, 150,    40,     40},
+    {"grid",    1000,   20,     0.5,    0.5},
+    {"grid",    10000,  25,     2,      0.5},
+    {"grid",    100000, 250,    30,     0.5},
+    {"rmat",    1000,   20,     0.5,    4},
+    {"rmat",    10000,  35,     2,      40},
+    {"rmat",    100000, 400,    50,     900},
+};
+
+// Random pairs searched per graph (the same pairs every run)
+constexpr unsigned PERF_QUERIES = 50;
+
+// Threads used for the timed loads
+constexpr unsigned PERF_LOAD_THREADS = 1;
+
+static double MillisecondsSince(std::chrono::high_resolution_clock::time_point start)
+{
+    return std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+}
+
+TEST(PerfThresholds)
+{
+    std::cout << std::fixed << std::setprecision(3);
+    for (const PerfThreshold& threshold : PERF_THRESHOLDS)
+    {
+        std::string name = std::string(threshold.kind) + "_" + std::to_string(threshold.size);
+        std::string path = WriteDataFile(GenerateGraph(threshold.kind, threshold.size, 1), "perf_" + name + ".bin");
+
+        LoadOptions options;
+        options.threads = PERF_LOAD_THREADS;
+
+        auto start = std::chrono::high_resolution_clock::now();
+        WikipediaSolver::LoadData(path, options);
+        double load_ms = MillisecondsSince(start);
+
+        std::span<const Article> articles = WikipediaSolver::GetArticles();
+        std::mt19937 random(threshold.size);
+        std::uniform_int_distribution<size_t> pick(0, articles.size() - 1);
+        std::vector<std::pair<const Article*, const Article*>> pairs(PERF_QUERIES);
+        for (auto& pair : pairs)
+            pair = {&articles[pick(random)], &articles[pick(random)]};
+
+        start = std::chrono::high_resolution_clock::now();
+        for (auto [from, to] : pairs)
+            WikipediaSolver::FindPathBFS(from, to);
+        double bfs_ms = MillisecondsSince(start) / PERF_QUERIES;
+
+        start = std::chrono::high_resolution_clock::now();
+        for (auto [from, to] : pairs)
+            WikipediaSolver::FindPathIDDFS(from, to);
+        double iddfs_ms = MillisecondsSince(start) / PERF_QUERIES;
+
+        std::cout << "  " << std::left << std::setw(14) << name << std::right
+                  << " load " << std::setw(9) << load_ms << "ms (limit " << threshold.max_load_ms << ")"
+                  << "  bfs " << std::setw(8) << bfs_ms << "ms (limit " << threshold.max_bfs_ms << ")"
+                  << "  iddfs " << std::setw(8) << iddfs_ms << "ms (limit " << threshold.max_iddfs_ms << ")\n";
+
+        CHECK(load_ms <= threshold.max_load_ms);
+        CHECK(bfs_ms <= threshold.max_bfs_ms);
+        CHECK(iddfs_ms <= threshold.max_iddfs_ms);
+    }
+}
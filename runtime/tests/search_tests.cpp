@@ -0,0 +1,264 @@
+#include "test.h"
+#include "graph_generator.h"
+#include "wikipedia.h"
+
+#include <algorithm>
+#include <climits>
+#include <deque>
+#include <unordered_map>
+
+// The loaded article with [id] (nullptr if there's none)
+static const Article* ArticleById(uint32_t id)
+{
+    for (const Article& article : WikipediaSolver::GetArticles())
+        if (article.id == id) return &article;
+    return nullptr;
+}
+
+// Page id -> index in the generated graph
+static std::unordered_map<uint32_t, size_t> IndexPages(const GeneratedGraph& graph)
+{
+    std::unordered_map<uint32_t, size_t> index_of;
+    for (size_t i = 0; i < graph.size(); i++)
+        index_of[graph.ids[i]] = i;
+    return index_of;
+}
+
+// Plain BFS over the generated graph, the number of links from [source] to every page (-1 if unreachable)
+static std::vector<int> ReferenceDistances(const GeneratedGraph& graph, const std::unordered_map<uint32_t, size_t>& index_of, size_t source)
+{
+    std::vector<int> distance(graph.size(), -1);
+    std::deque<size_t> queue = {source};
+    distance[source] = 0;
+
+    while (!queue.empty())
+    {
+        size_t current = queue.front();
+        queue.pop_front();
+
+        for (uint32_t link : graph.links[current])
+        {
+            auto next = index_of.find(link);
+            if (next == index_of.end() || distance[next->second] >= 0) continue;
+            distance[next->second] = distance[current] + 1;
+            queue.push_back(next->second);
+        }
+    }
+    return distance;
+}
+
+// A found path has to start and end at the searched pages and only follow real links
+static bool ValidPath(const GeneratedGraph& graph, const std::unordered_map<uint32_t, size_t>& index_of,
+                      const std::vector<const Article*>& path, const Article* from, const Article* to)
+{
+    if (path.empty()) return true;
+    if (path.front() != from || path.back() != to) return false;
+
+    for (size_t i = 0; i + 1 < path.size(); i++)
+    {
+        const auto& links = graph.links[index_of.at(path[i]->id)];
+        if (std::find(links.begin(), links.end(), path[i+1]->id) == links.end()) return false;
+    }
+    return true;
+}
+
+// Loads the graph and runs both searches on every pair of pages (including a page with itself)
+// BFS has to find a shortest path whenever one exists, IDDFS too as long as it fits in its depth limit
+static void CheckAllPairs(const GeneratedGraph& graph, const std::string& name)
+{
+    WikipediaSolver::LoadData(WriteDataFile(graph, name + ".bin"));
+
+    std::span<const Article> articles = WikipediaSolver::GetArticles();
+    CHECK_EQ(articles.size(), graph.size(), name);
+
+    auto index_of = IndexPages(graph);
+    for (const Article& from : articles)
+    {
+        std::vector<int> distance = ReferenceDistances(graph, index_of, index_of.at(from.id));
+        for (const Article& to : articles)
+        {
+            int links = distance[index_of.at(to.id)];
+            size_t expected = links < 0 ? 0 : links + 1;
+
+            auto bfs = WikipediaSolver::FindPathBFS(&from, &to);
+            CHECK_EQ(bfs.size(), expected, "BFS " << name << " " << from.id << " -> " << to.id);
+            CHECK(ValidPath(graph, index_of, bfs, &from, &to));
+
+            auto iddfs = WikipediaSolver::FindPathIDDFS(&from, &to);
+            CHECK_EQ(iddfs.size(), (expected <= (size_t)WikipediaSolver::MAX_IDDFS_DEPTH ? expected : 0), "IDDFS " << name << " " << from.id << " -> " << to.id);
+            CHECK(ValidPath(graph, index_of, iddfs, &from, &to));
+        }
+    }
+}
+
+// Long enough that far away pages are past the IDDFS limit, and every backwards pair is unreachable
+TEST(ChainSearchesMatch)
+{
+    CheckAllPairs(GenerateChain(30), "chain");
+}
+
+TEST(StarSearchesMatch)
+{
+    CheckAllPairs(GenerateStar(40), "star");
+}
+
+// 50 pages leave the last row of the 8 wide grid partly empty
+TEST(GridSearchesMatch)
+{
+    CheckAllPairs(GenerateGrid(50), "grid");
+}
+
+TEST(RMATSearchesMatch)
+{
+    GeneratedGraph graph = GenerateRMAT(200, 1);
+    AddDanglingLinks(graph, 50, 2);
+    CheckAllPairs(graph, "rmat");
+}
+
+TEST(SelfQueriesReturnThePage)
+{
+    WikipediaSolver::LoadData(WriteDataFile(GenerateStar(10), "self.bin"));
+
+    for (const Article& article : WikipediaSolver::GetArticles())
+    {
+        auto bfs = WikipediaSolver::FindPathBFS(&article, &article);
+        CHECK_EQ(bfs.size(), 1u, "BFS " << article.id);
+        CHECK(bfs.size() == 1 && bfs[0] == &article);
+
+        auto iddfs = WikipediaSolver::FindPathIDDFS(&article, &article);
+        CHECK_EQ(iddfs.size(), 1u, "IDDFS " << article.id);
+        CHECK(iddfs.size() == 1 && iddfs[0] == &article);
+    }
+}
+
+// A short chain plus a page nothing links to and that links nowhere
+TEST(UnreachableTargetsReturnNothing)
+{
+    GeneratedGraph graph = GenerateChain(5);
+    graph.AddPage(6, "Island");
+    WikipediaSolver::LoadData(WriteDataFile(graph, "unreachable.bin"));
+
+    std::pair<uint32_t, uint32_t> pairs[] = {{1, 6}, {6, 1}, {5, 1}, {3, 2}};
+    for (auto [from, to] : pairs)
+    {
+        CHECK_EQ(WikipediaSolver::FindPathBFS(ArticleById(from), ArticleById(to)).size(), 0u, "BFS " << from << " -> " << to);
+        CHECK_EQ(WikipediaSolver::FindPathIDDFS(ArticleById(from), ArticleById(to)).size(), 0u, "IDDFS " << from << " -> " << to);
+    }
+}
+
+// Links past the largest page id are skipped by the searches, and only rejected when validating
+TEST(DanglingLinksOnlyFailValidation)
+{
+    GeneratedGraph graph = GenerateChain(20);
+    AddDanglingLinks(graph, 40, 3);
+    std::string path = WriteDataFile(graph, "dangling.bin");
+
+    WikipediaSolver::LoadData(path);
+    CHECK_EQ(WikipediaSolver::GetArticles().size(), 20u, "");
+    CHECK_EQ(WikipediaSolver::FindPathBFS(ArticleById(1), ArticleById(20)).size(), 20u, "");
+    CHECK_EQ(WikipediaSolver::FindPathIDDFS(ArticleById(1), ArticleById(10)).size(), 10u, "");
+
+    LoadOptions options;
+    options.validate = true;
+    CHECK_THROWS(WikipediaSolver::LoadData(path, options));
+}
+
+TEST(OversizedPageIdIsRejected)
+{
+    GeneratedGraph graph;
+    graph.AddPage(0xFFFFFFFF, "Too_big");
+    CHECK_THROWS(WikipediaSolver::LoadData(WriteDataFile(graph, "oversized.bin")));
+
+    GeneratedGraph duplicate = GenerateChain(3);
+    duplicate.AddPage(2, "Again");
+    CHECK_THROWS(WikipediaSolver::LoadData(WriteDataFile(duplicate, "duplicate.bin")));
+}
+
+// A load that fails part way has to leave the previous graph fully usable
+// The rejected graph is much bigger, so anything left over from it would index past the old id table
+TEST(RejectedLoadKeepsPreviousData)
+{
+    WikipediaSolver::LoadData(WriteDataFile(GenerateChain(5), "kept.bin"));
+
+    GeneratedGraph dangling = GenerateChain(200000);
+    AddDanglingLinks(dangling, 10, 6);
+    LoadOptions options;
+    options.validate = true;
+    CHECK_THROWS(WikipediaSolver::LoadData(WriteDataFile(dangling, "rejected.bin"), options));
+
+    GeneratedGraph duplicate = GenerateChain(200000);
+    duplicate.AddPage(100000, "Again");
+    CHECK_THROWS(WikipediaSolver::LoadData(WriteDataFile(duplicate, "rejected_duplicate.bin")));
+
+    CHECK_EQ(WikipediaSolver::GetArticles().size(), 5u, "");
+    CHECK_EQ(WikipediaSolver::FindPathBFS(ArticleById(1), ArticleById(5)).size(), 5u, "");
+    CHECK_EQ(WikipediaSolver::FindPathIDDFS(ArticleById(2), ArticleById(4)).size(), 3u, "");
+    CHECK(ArticleById(100000) == nullptr);
+
+    auto results = WikipediaSolver::SearchTitle("chain 0000003", 1);
+    CHECK(!results.empty());
+    if (!results.empty()) CHECK_EQ(results[0]->id, 3u, "");
+}
+
+// Regression test for IDDFS missing shortest paths
+// 1 links to 3 then 2, so the DFS pops 2 first and reaches 5 through 2 -> 4 -> 5 (depth 3)
+// The shortest path 1 -> 3 -> 5 -> 6 needs 5 at depth 2, which used to be skipped as already visited
+TEST(IDDFSFindsShallowerRoute)
+{
+    GeneratedGraph graph;
+    for (const char* title : {"A", "B", "C", "D", "E", "F"})
+        graph.AddPage((uint32_t)graph.size() + 1, title);
+    graph.links[0] = {3, 2};
+    graph.links[1] = {4};
+    graph.links[2] = {5};
+    graph.links[3] = {5};
+    graph.links[4] = {6};
+    WikipediaSolver::LoadData(WriteDataFile(graph, "trap.bin"));
+
+    auto path = WikipediaSolver::FindPathIDDFS(ArticleById(1), ArticleById(6));
+    CHECK_EQ(path.size(), 4u, "");
+    if (path.size() == 4)
+    {
+        CHECK_EQ(path[1]->title, "C", "");
+        CHECK_EQ(path[2]->title, "E", "");
+    }
+}
+
+TEST(TitleSearchFindsExactTitle)
+{
+    WikipediaSolver::LoadData(WriteDataFile(GenerateChain(100), "titles.bin"));
+
+    // Underscores are stored as spaces and the search ignores case
+    auto results = WikipediaSolver::SearchTitle("chain 0000042", 3);
+    CHECK(!results.empty());
+    if (!results.empty()) CHECK_EQ(results[0]->id, 42u, "");
+}
+
+// The parallel loader has to build the same graph and title index no matter how many threads it uses
+// (including far more threads than there are pages)
+// Big enough that every loading step is split across several threads
+TEST(LoadIsThreadCountIndependent)
+{
+    GeneratedGraph graph = GenerateRMAT(100000, 4);
+    AddDanglingLinks(graph, 100, 5);
+    std::string path = WriteDataFile(graph, "threads.bin");
+
+    auto snapshot = [&](unsigned threads) {
+        LoadOptions options;
+        options.threads = threads;
+        WikipediaSolver::LoadData(path, options);
+
+        std::span<const Article> articles = WikipediaSolver::GetArticles();
+        std::vector<uint32_t> result;
+        for (const char* search : {"rmat", "Rmat 00001", "r", "x"})
+            for (const Article* article : WikipediaSolver::SearchTitle(search, 10))
+                result.push_back(article->id);
+        for (size_t i = 0; i < 50; i++)
+            result.push_back((uint32_t)WikipediaSolver::FindPathBFS(&articles[i * 37 % articles.size()], &articles[i * 91 % articles.size()]).size());
+        return result;
+    };
+
+    std::vector<uint32_t> single = snapshot(1);
+    for (unsigned threads : {2u, 3u, 8u, UINT_MAX})
+        CHECK(snapshot(threads) == single);
+}
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// A tiny test harness so the tests build without pulling in another dependency
+// Tests register themselves with TEST, CHECKs report failures without stopping the test
+
+struct TestCase
+{
+    const char* name;
+    void (*run)();
+};
+
+std::vector<TestCase>& TestRegistry();
+void ReportFailure(const char* file, int line, const std::string& message);
+
+#define TEST(name) \
+    static void name(); \
+    static const bool name##_registered = (TestRegistry().push_back({#name, name}), true); \
+    static void name()
+
+#define CHECK(condition) \
+    do { if (!(condition)) ReportFailure(__FILE__, __LINE__, #condition); } while (0)
+
+// Prints both values when they differ, plus some context (like which pair of pages was searched)
+#define CHECK_EQ(actual, expected, context) \
+    do { \
+        auto actual_value = (actual); \
+        auto expected_value = (expected); \
+        if (!(actual_value == expected_value)) \
+        { \
+            std::ostringstream message; \
+            message << #actual << " == " << #expected << " (got " << actual_value << ", expected " << expected_value << ") " << context; \
+            ReportFailure(__FILE__, __LINE__, message.str()); \
+        } \
+    } while (0)
+
+// Passes if the statement throws a std::exception of any kind
+#define CHECK_THROWS(statement) \
+    do { \
+        bool threw = false; \
+        try { statement; } catch (const std::exception&) { threw = true; } \
+        if (!threw) ReportFailure(__FILE__, __LINE__, #statement " didn't throw"); \
+    } while (0)
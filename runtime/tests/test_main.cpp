@@ -0,0 +1,59 @@
+#include "test.h"
+
+#include <chrono>
+#include <cstring>
+
+static int s_Failures = 0;
+
+// Failures past this many in one test are counted but not printed
+constexpr int MAX_PRINTED_FAILURES = 20;
+static int s_TestFailures = 0;
+
+std::vector<TestCase>& TestRegistry()
+{
+    static std::vector<TestCase> registry;
+    return registry;
+}
+
+void ReportFailure(const char* file, int line, const std::string& message)
+{
+    s_Failures++;
+    if (++s_TestFailures <= MAX_PRINTED_FAILURES)
+        std::cout << "  " << file << ":" << line << ": " << message << "\n";
+}
+
+// Runs every test, or only the ones whose name contains the first argument
+int main(int argc, char** argv)
+{
+    int failed_tests = 0;
+    int ran_tests = 0;
+
+    for (const TestCase& test : TestRegistry())
+    {
+        if (argc > 1 && !std::strstr(test.name, argv[1])) continue;
+
+        std::cout << test.name << "\n";
+        s_TestFailures = 0;
+
+        auto start = std::chrono::high_resolution_clock::now();
+        try
+        {
+            test.run();
+        }
+        catch (const std::exception& e)
+        {
+            ReportFailure(__FILE__, __LINE__, std::string("unexpected exception: ") + e.what());
+        }
+        auto end = std::chrono::high_resolution_clock::now();
+
+        ran_tests++;
+        if (s_TestFailures > 0) failed_tests++;
+        std::cout << "  " << (s_TestFailures > 0 ? "FAILED" : "passed") << " in "
+                  << std::chrono::duration_cast<std::chrono::milliseconds>(end-start).count() << "ms";
+        if (s_TestFailures > MAX_PRINTED_FAILURES) std::cout << " (" << s_TestFailures << " failures)";
+        std::cout << "\n";
+    }
+
+    std::cout << ran_tests - failed_tests << "/" << ran_tests << " tests passed\n";
+    return s_Failures > 0 ? 1 : 0;
+}
@@ -0,0 +1,5 @@
+cd runtime
+premake5 ninja
+ninja tests_test
+cd ..
+runtime\build\bin\test\tests
\ No newline at end of file